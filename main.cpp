@@ -8,6 +8,23 @@
 #include <iomanip>
 #include <ctime>
 #include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <climits>
+#include <cstdio>
+#include <cctype>
+#include <string_view>
+#include <unordered_set>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <unordered_map>
 
 using namespace std;
 
@@ -18,12 +35,230 @@ public:
     static const string USER;
     static const string PASSWORD;
     static const string DATABASE;
+    
+    // Optional read-only replica for reporting queries (empty = primary only)
+    static const string REPLICA_HOST;
+    static const string REPLICA_USER;
+    static const string REPLICA_PASSWORD;
+    static const double REPLICA_MAX_WAIT_SECONDS;
+    static const int REPLICA_RETRY_SECONDS;
 };
 
 const string DatabaseConfig::HOST = "tcp://127.0.0.1:3306";
 const string DatabaseConfig::USER = "root";
 const string DatabaseConfig::PASSWORD = "your_password"; // Change this
 const string DatabaseConfig::DATABASE = "banking_system";
+const string DatabaseConfig::REPLICA_HOST = ""; // e.g. "tcp://127.0.0.1:3307"
+const string DatabaseConfig::REPLICA_USER = "root";
+const string DatabaseConfig::REPLICA_PASSWORD = "your_password"; // Change this
+const double DatabaseConfig::REPLICA_MAX_WAIT_SECONDS = 0.05; // Short wait before falling back to primary
+const int DatabaseConfig::REPLICA_RETRY_SECONDS = 30; // Delay before reconnecting a failed replica
+
+// Transaction ledger archival settings
+class LedgerConfig {
+public:
+    static const string ARCHIVE_DIR;
+    static const int LIVE_MONTHS;
+};
+
+const string LedgerConfig::ARCHIVE_DIR = "ledger_archive";
+const int LedgerConfig::LIVE_MONTHS = 12; // Months kept in MySQL before archiving
+
+// Default withdrawal/transfer limits per account type, in dollars
+class LimitConfig {
+public:
+    static const double SAVINGS_HOURLY_WITHDRAWAL;
+    static const double SAVINGS_DAILY_WITHDRAWAL;
+    static const double SAVINGS_HOURLY_TRANSFER;
+    static const double SAVINGS_DAILY_TRANSFER;
+    static const double CURRENT_HOURLY_WITHDRAWAL;
+    static const double CURRENT_DAILY_WITHDRAWAL;
+    static const double CURRENT_HOURLY_TRANSFER;
+    static const double CURRENT_DAILY_TRANSFER;
+};
+
+const double LimitConfig::SAVINGS_HOURLY_WITHDRAWAL = 2000.00;
+const double LimitConfig::SAVINGS_DAILY_WITHDRAWAL = 5000.00;
+const double LimitConfig::SAVINGS_HOURLY_TRANSFER = 5000.00;
+const double LimitConfig::SAVINGS_DAILY_TRANSFER = 10000.00;
+const double LimitConfig::CURRENT_HOURLY_WITHDRAWAL = 10000.00;
+const double LimitConfig::CURRENT_DAILY_WITHDRAWAL = 25000.00;
+const double LimitConfig::CURRENT_HOURLY_TRANSFER = 25000.00;
+const double LimitConfig::CURRENT_DAILY_TRANSFER = 50000.00;
+
+// Request tracing settings
+class TraceConfig {
+public:
+    static const double SAMPLE_RATE;
+    static const size_t BUFFER_EVENTS;
+    static const string OUTPUT_FILE;
+};
+
+const double TraceConfig::SAMPLE_RATE = 0.0; // Fraction of operations traced (0 = off)
+const size_t TraceConfig::BUFFER_EVENTS = 65536; // Most recent spans kept per thread
+const string TraceConfig::OUTPUT_FILE = "banking_trace.json";
+
+// Span recorder. Each thread writes completed spans into its own ring buffer
+// without locking; the exporter reads them back through per-slot sequence
+// numbers, skipping any slot that is overwritten while being copied. The
+// sampling decision is made once per outermost span, so a request is either
+// traced completely or not at all.
+class Tracer {
+private:
+    struct Event {
+        const char *name;
+        long long startMicros;
+        long long durationMicros;
+        uint64_t requestId;
+    };
+    
+    struct Slot {
+        atomic<uint64_t> sequence{0}; // 2n+1 while event n is written, 2n+2 once complete
+        Event event;
+    };
+    
+    struct ThreadBuffer {
+        int threadId;
+        vector<Slot> slots;
+        atomic<uint64_t> head{0};
+        
+        ThreadBuffer(int id, size_t capacity) : threadId(id), slots(capacity) {}
+    };
+    
+    // Current request state, only touched by the owning thread
+    struct ThreadState {
+        int depth = 0;
+        bool sampled = false;
+        uint64_t requestId = 0;
+        ThreadBuffer *buffer = nullptr; // Allocated on the first sampled span
+    };
+    
+    static mutex registryMutex;
+    static vector<shared_ptr<ThreadBuffer>> buffers;
+    static atomic<uint64_t> nextRequestId;
+    
+    static ThreadState &local() {
+        thread_local ThreadState state;
+        return state;
+    }
+    
+    static ThreadBuffer &bufferFor(ThreadState &state) {
+        if (!state.buffer) {
+            lock_guard<mutex> lock(registryMutex);
+            buffers.push_back(make_shared<ThreadBuffer>(static_cast<int>(buffers.size()) + 1,
+                                                        TraceConfig::BUFFER_EVENTS));
+            state.buffer = buffers.back().get();
+        }
+        return *state.buffer;
+    }
+    
+    static bool shouldSample() {
+        double rate = TraceConfig::SAMPLE_RATE;
+        if (rate <= 0.0) return false;
+        if (rate >= 1.0) return true;
+        thread_local minstd_rand generator(random_device{}());
+        return uniform_real_distribution<double>(0.0, 1.0)(generator) < rate;
+    }
+
+public:
+    static long long nowMicros() {
+        static const auto origin = chrono::steady_clock::now();
+        return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - origin).count();
+    }
+    
+    // Returns whether the span being opened is recorded
+    static bool beginSpan() {
+        ThreadState &state = local();
+        if (state.depth++ == 0) {
+            state.sampled = shouldSample();
+            if (state.sampled) state.requestId = nextRequestId.fetch_add(1, memory_order_relaxed);
+        }
+        return state.sampled;
+    }
+    
+    static void endSpan(const char *name, long long startMicros, bool sampled) {
+        ThreadState &state = local();
+        state.depth--;
+        if (!sampled) return;
+        
+        ThreadBuffer &buffer = bufferFor(state);
+        uint64_t index = buffer.head.load(memory_order_relaxed);
+        Slot &slot = buffer.slots[index % buffer.slots.size()];
+        slot.sequence.store(2 * index + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        slot.event = {name, startMicros, nowMicros() - startMicros, state.requestId};
+        slot.sequence.store(2 * index + 2, memory_order_release);
+        buffer.head.store(index + 1, memory_order_release);
+    }
+    
+    // Write all buffered spans as Chrome trace-event JSON (loadable in Perfetto)
+    static bool writeChromeTrace(const string &path) {
+        vector<shared_ptr<ThreadBuffer>> snapshot;
+        {
+            lock_guard<mutex> lock(registryMutex);
+            snapshot = buffers;
+        }
+        
+        ofstream out(path, ios::trunc);
+        if (!out) {
+            cerr << "Error opening trace file " << path << endl;
+            return false;
+        }
+        
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        size_t written = 0;
+        for (const auto &buffer : snapshot) {
+            uint64_t head = buffer->head.load(memory_order_acquire);
+            uint64_t capacity = buffer->slots.size();
+            for (uint64_t index = (head > capacity) ? head - capacity : 0; index < head; index++) {
+                const Slot &slot = buffer->slots[index % capacity];
+                uint64_t before = slot.sequence.load(memory_order_acquire);
+                if (before != 2 * index + 2) continue;
+                Event event = slot.event;
+                atomic_thread_fence(memory_order_acquire);
+                if (slot.sequence.load(memory_order_relaxed) != before) continue;
+                
+                out << (first ? "" : ",") << "\n{\"name\":\"" << event.name
+                    << "\",\"cat\":\"banking\",\"ph\":\"X\",\"ts\":" << event.startMicros
+                    << ",\"dur\":" << event.durationMicros
+                    << ",\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"args\":{\"request\":" << event.requestId << "}}";
+                first = false;
+                written++;
+            }
+        }
+        out << "\n]}\n";
+        
+        cout << "Wrote " << written << " trace spans to " << path << endl;
+        return true;
+    }
+};
+
+mutex Tracer::registryMutex;
+vector<shared_ptr<Tracer::ThreadBuffer>> Tracer::buffers;
+atomic<uint64_t> Tracer::nextRequestId(1);
+
+// RAII span covering the enclosing scope
+class TraceSpan {
+private:
+    const char *name;
+    long long startMicros;
+    bool sampled;
+
+public:
+    explicit TraceSpan(const char *spanName)
+        : name(spanName), startMicros(0), sampled(Tracer::beginSpan()) {
+        if (sampled) startMicros = Tracer::nowMicros();
+    }
+    
+    ~TraceSpan() {
+        Tracer::endSpan(name, startMicros, sampled);
+    }
+    
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+};
 
 // Base Account class
 class Account {
@@ -120,7 +355,7 @@ const double CurrentAccount::PENALTY_FEE = 25.00;
 // Transaction class
 class Transaction {
 private:
-    int transactionId;
+    long long transactionId;
     int accountNumber;
     string transactionType;
     double amount;
@@ -154,11 +389,685 @@ public:
     friend class BankingSystem;
 };
 
+// Archived ledger row; amounts are kept in cents so segments round-trip exactly
+struct LedgerRow {
+    long long transactionId;
+    int accountNumber;
+    string transactionType;
+    long long amountCents;
+    long long balanceAfterCents;
+    long long timestamp;
+    string description;
+};
+
+// Min/max index over a run of archived rows
+struct SegmentRange {
+    long long rowCount = 0;
+    long long minAccount = 0;
+    long long maxAccount = 0;
+    long long minTimestamp = 0;
+    long long maxTimestamp = 0;
+    
+    bool overlaps(int accountNumber, long long fromTs, long long toTs) const {
+        return accountNumber >= minAccount && accountNumber <= maxAccount &&
+               maxTimestamp >= fromTs && minTimestamp < toTs;
+    }
+};
+
+// Directory entry for one independently decodable block of a segment
+struct SegmentBlock : SegmentRange {
+    long long offset = 0; // From the end of the header
+    long long length = 0;
+};
+
+// Segment-wide range plus block directory, stored at the front of every segment file
+struct SegmentHeader : SegmentRange {
+    vector<SegmentBlock> blocks;
+};
+
+// Compressed columnar segment file holding one archived ledger partition.
+// Rows are sorted by account and cut into fixed-size blocks, each with its own
+// min/max entry, so a lookup only decodes the blocks covering its account.
+// Within a block numeric columns are delta/zig-zag varint encoded, transaction
+// types and descriptions are dictionary encoded since they repeat heavily.
+class LedgerSegment {
+private:
+    static const string MAGIC;
+    static const size_t FIXED_HEADER_SIZE;
+    static const size_t BLOCK_ENTRY_SIZE;
+    static const size_t BLOCK_ROWS;
+    
+    static void putVarint(string &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+    
+    static uint64_t getVarint(const string &in, size_t &pos) {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos >= in.size()) throw runtime_error("truncated segment");
+            uint8_t byte = static_cast<uint8_t>(in[pos++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        throw runtime_error("corrupt varint in segment");
+    }
+    
+    static uint64_t zigzag(long long value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+    
+    static long long unzigzag(uint64_t value) {
+        return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+    }
+    
+    static void putFixed(string &out, long long value) {
+        for (int i = 0; i < 8; i++) {
+            out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+        }
+    }
+    
+    static long long getFixed(const string &in, size_t &pos) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++) {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(in[pos++])) << (8 * i);
+        }
+        return static_cast<long long>(value);
+    }
+    
+    static void putRange(string &out, const SegmentRange &range) {
+        putFixed(out, range.rowCount);
+        putFixed(out, range.minAccount);
+        putFixed(out, range.maxAccount);
+        putFixed(out, range.minTimestamp);
+        putFixed(out, range.maxTimestamp);
+    }
+    
+    static void getRange(const string &in, size_t &pos, SegmentRange &range) {
+        range.rowCount = getFixed(in, pos);
+        range.minAccount = getFixed(in, pos);
+        range.maxAccount = getFixed(in, pos);
+        range.minTimestamp = getFixed(in, pos);
+        range.maxTimestamp = getFixed(in, pos);
+    }
+    
+    // rows must be non-empty and sorted by account
+    static SegmentRange rangeOf(vector<LedgerRow>::const_iterator first, vector<LedgerRow>::const_iterator last) {
+        SegmentRange range;
+        range.rowCount = last - first;
+        range.minAccount = first->accountNumber;
+        range.maxAccount = (last - 1)->accountNumber;
+        range.minTimestamp = first->timestamp;
+        range.maxTimestamp = first->timestamp;
+        for (auto it = first; it != last; ++it) {
+            range.minTimestamp = min(range.minTimestamp, it->timestamp);
+            range.maxTimestamp = max(range.maxTimestamp, it->timestamp);
+        }
+        return range;
+    }
+    
+    // Dictionary-encode a string column: distinct values first, then codes
+    static void putDictionary(string &out, vector<LedgerRow>::const_iterator first,
+                              vector<LedgerRow>::const_iterator last, string LedgerRow::*field) {
+        map<string, uint64_t> codes;
+        vector<const string*> values;
+        for (auto it = first; it != last; ++it) {
+            if (codes.emplace((*it).*field, values.size()).second) {
+                values.push_back(&((*it).*field));
+            }
+        }
+        putVarint(out, values.size());
+        for (const string *value : values) {
+            putVarint(out, value->size());
+            out += *value;
+        }
+        for (auto it = first; it != last; ++it) {
+            putVarint(out, codes[(*it).*field]);
+        }
+    }
+    
+    static void getDictionary(const string &in, size_t &pos, vector<LedgerRow> &rows, string LedgerRow::*field) {
+        vector<string> values(getVarint(in, pos));
+        for (string &value : values) {
+            size_t length = getVarint(in, pos);
+            if (pos + length > in.size()) throw runtime_error("truncated segment");
+            value = in.substr(pos, length);
+            pos += length;
+        }
+        for (LedgerRow &row : rows) {
+            uint64_t code = getVarint(in, pos);
+            if (code >= values.size()) throw runtime_error("corrupt dictionary code in segment");
+            row.*field = values[code];
+        }
+    }
+    
+    static void encodeBlock(string &out, vector<LedgerRow>::const_iterator first, vector<LedgerRow>::const_iterator last) {
+        long long prevAccount = 0, prevId = 0, prevTs = 0;
+        for (auto it = first; it != last; ++it) {
+            putVarint(out, zigzag(it->accountNumber - prevAccount));
+            prevAccount = it->accountNumber;
+        }
+        for (auto it = first; it != last; ++it) {
+            putVarint(out, zigzag(it->transactionId - prevId));
+            prevId = it->transactionId;
+        }
+        for (auto it = first; it != last; ++it) {
+            putVarint(out, zigzag(it->timestamp - prevTs));
+            prevTs = it->timestamp;
+        }
+        for (auto it = first; it != last; ++it) putVarint(out, zigzag(it->amountCents));
+        for (auto it = first; it != last; ++it) putVarint(out, zigzag(it->balanceAfterCents));
+        putDictionary(out, first, last, &LedgerRow::transactionType);
+        putDictionary(out, first, last, &LedgerRow::description);
+    }
+    
+    static void decodeBlock(const string &in, long long rowCount, vector<LedgerRow> &rows) {
+        if (rowCount < 0 || static_cast<size_t>(rowCount) > in.size()) {
+            throw runtime_error("corrupt row count in segment");
+        }
+        
+        size_t pos = 0;
+        rows.assign(rowCount, LedgerRow());
+        long long account = 0, id = 0, ts = 0;
+        for (LedgerRow &row : rows) {
+            account += unzigzag(getVarint(in, pos));
+            row.accountNumber = static_cast<int>(account);
+        }
+        for (LedgerRow &row : rows) {
+            id += unzigzag(getVarint(in, pos));
+            row.transactionId = id;
+        }
+        for (LedgerRow &row : rows) {
+            ts += unzigzag(getVarint(in, pos));
+            row.timestamp = ts;
+        }
+        for (LedgerRow &row : rows) row.amountCents = unzigzag(getVarint(in, pos));
+        for (LedgerRow &row : rows) row.balanceAfterCents = unzigzag(getVarint(in, pos));
+        getDictionary(in, pos, rows, &LedgerRow::transactionType);
+        getDictionary(in, pos, rows, &LedgerRow::description);
+    }
+
+public:
+    // Write rows to path atomically (temp file + rename)
+    static bool write(const string &path, vector<LedgerRow> rows) {
+        if (rows.empty()) return false;
+        
+        // Group by account so block ranges are narrow and account deltas small
+        sort(rows.begin(), rows.end(), [](const LedgerRow &a, const LedgerRow &b) {
+            if (a.accountNumber != b.accountNumber) return a.accountNumber < b.accountNumber;
+            return a.transactionId < b.transactionId;
+        });
+        
+        SegmentHeader header;
+        static_cast<SegmentRange &>(header) = rangeOf(rows.begin(), rows.end());
+        
+        string body;
+        for (size_t start = 0; start < rows.size(); start += BLOCK_ROWS) {
+            auto first = rows.cbegin() + start;
+            auto last = rows.cbegin() + min(start + BLOCK_ROWS, rows.size());
+            
+            SegmentBlock block;
+            static_cast<SegmentRange &>(block) = rangeOf(first, last);
+            block.offset = static_cast<long long>(body.size());
+            encodeBlock(body, first, last);
+            block.length = static_cast<long long>(body.size()) - block.offset;
+            header.blocks.push_back(block);
+        }
+        
+        string out = MAGIC;
+        putRange(out, header);
+        putFixed(out, static_cast<long long>(header.blocks.size()));
+        for (const SegmentBlock &block : header.blocks) {
+            putRange(out, block);
+            putFixed(out, block.offset);
+            putFixed(out, block.length);
+        }
+        out += body;
+        
+        string tmpPath = path + ".tmp";
+        {
+            ofstream file(tmpPath, ios::binary | ios::trunc);
+            if (!file.write(out.data(), out.size())) {
+                cerr << "Error writing segment " << tmpPath << endl;
+                return false;
+            }
+        }
+        error_code ec;
+        filesystem::rename(tmpPath, path, ec);
+        if (ec) {
+            cerr << "Error renaming segment " << tmpPath << ": " << ec.message() << endl;
+            return false;
+        }
+        return true;
+    }
+    
+    // Read the segment range and block directory without touching row data
+    static bool readHeader(const string &path, SegmentHeader &header) {
+        ifstream file(path, ios::binary);
+        string in(FIXED_HEADER_SIZE, '\0');
+        if (!file.read(&in[0], FIXED_HEADER_SIZE) || in.compare(0, MAGIC.size(), MAGIC) != 0) {
+            cerr << "Invalid segment file " << path << endl;
+            return false;
+        }
+        size_t pos = MAGIC.size();
+        getRange(in, pos, header);
+        long long blockCount = getFixed(in, pos);
+        
+        error_code ec;
+        uintmax_t fileSize = filesystem::file_size(path, ec);
+        if (ec || blockCount < 0 || static_cast<uintmax_t>(blockCount) * BLOCK_ENTRY_SIZE > fileSize) {
+            cerr << "Invalid segment file " << path << endl;
+            return false;
+        }
+        
+        string directory(blockCount * BLOCK_ENTRY_SIZE, '\0');
+        if (blockCount > 0 && !file.read(&directory[0], directory.size())) {
+            cerr << "Invalid segment file " << path << endl;
+            return false;
+        }
+        pos = 0;
+        header.blocks.assign(blockCount, SegmentBlock());
+        for (SegmentBlock &block : header.blocks) {
+            getRange(directory, pos, block);
+            block.offset = getFixed(directory, pos);
+            block.length = getFixed(directory, pos);
+        }
+        return true;
+    }
+    
+    // Append rows for accountNumber within [fromTs, toTs), decoding only the
+    // blocks whose directory entry overlaps the request
+    static bool read(const string &path, const SegmentHeader &header, int accountNumber,
+                     long long fromTs, long long toTs, vector<LedgerRow> &rows) {
+        ifstream file(path, ios::binary);
+        if (!file) {
+            cerr << "Error opening segment " << path << endl;
+            return false;
+        }
+        long long dataStart = FIXED_HEADER_SIZE + header.blocks.size() * BLOCK_ENTRY_SIZE;
+        
+        try {
+            for (const SegmentBlock &block : header.blocks) {
+                if (!block.overlaps(accountNumber, fromTs, toTs)) continue;
+                
+                string in(block.length, '\0');
+                file.seekg(dataStart + block.offset);
+                if (!file.read(&in[0], block.length)) throw runtime_error("truncated segment");
+                
+                vector<LedgerRow> blockRows;
+                decodeBlock(in, block.rowCount, blockRows);
+                for (LedgerRow &row : blockRows) {
+                    if (row.accountNumber == accountNumber && row.timestamp >= fromTs && row.timestamp < toTs) {
+                        rows.push_back(move(row));
+                    }
+                }
+            }
+        } catch (runtime_error &e) {
+            cerr << "Error reading segment " << path << ": " << e.what() << endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+const string LedgerSegment::MAGIC = "BKLSEG02";
+const size_t LedgerSegment::FIXED_HEADER_SIZE = 8 + 6 * 8;
+const size_t LedgerSegment::BLOCK_ENTRY_SIZE = 7 * 8;
+const size_t LedgerSegment::BLOCK_ROWS = 4096;
+
+// In-memory prefix search over account holder names, emails and phone numbers.
+// Normalized keys live in one string arena referenced by a sorted array, so a
+// lookup is a binary search plus a short forward scan. New keys collect in a
+// small unsorted buffer that is merged into the sorted array once it grows.
+class AccountSearchIndex {
+private:
+    struct Entry {
+        uint64_t offset; // 64-bit so arenas past 4 GiB still resolve correctly
+        uint16_t length;
+        int accountNumber;
+    };
+    
+    static const size_t MERGE_THRESHOLD = 4096;
+    static const size_t MIN_PHONE_SUFFIX = 7; // Shortest local number indexed on its own
+    
+    string arena;
+    vector<Entry> entries;     // Sorted by key
+    vector<Entry> pending;     // Unsorted, scanned linearly
+    unordered_set<int> removed; // Closed accounts awaiting purge on next merge
+    bool bulkLoading = false;
+    
+    string_view keyOf(const Entry &entry) const {
+        return string_view(arena).substr(entry.offset, entry.length);
+    }
+    
+    void addKey(const string &key, int accountNumber) {
+        if (key.empty()) return;
+        size_t length = min<size_t>(key.size(), UINT16_MAX);
+        pending.push_back({static_cast<uint64_t>(arena.size()), static_cast<uint16_t>(length), accountNumber});
+        arena.append(key, 0, length);
+    }
+    
+    void merge() {
+        auto byKey = [this](const Entry &a, const Entry &b) { return keyOf(a) < keyOf(b); };
+        sort(pending.begin(), pending.end(), byKey);
+        
+        vector<Entry> merged;
+        merged.reserve(entries.size() + pending.size());
+        std::merge(entries.begin(), entries.end(), pending.begin(), pending.end(),
+                   back_inserter(merged), byKey);
+        pending.clear();
+        
+        // Purge closed accounts and compact the arena behind them
+        if (!removed.empty()) {
+            string compacted;
+            vector<Entry> kept;
+            kept.reserve(merged.size());
+            for (const Entry &entry : merged) {
+                if (removed.count(entry.accountNumber)) continue;
+                kept.push_back({static_cast<uint64_t>(compacted.size()), entry.length, entry.accountNumber});
+                compacted.append(keyOf(entry));
+            }
+            arena.swap(compacted);
+            merged.swap(kept);
+            removed.clear();
+        }
+        entries.swap(merged);
+    }
+    
+    // Lowercase letters and digits; any other run of characters becomes one space
+    static string normalizeText(const string &text) {
+        string out;
+        for (unsigned char c : text) {
+            if (isalnum(c)) {
+                out.push_back(static_cast<char>(tolower(c)));
+            } else if (!out.empty() && out.back() != ' ') {
+                out.push_back(' ');
+            }
+        }
+        if (!out.empty() && out.back() == ' ') out.pop_back();
+        return out;
+    }
+    
+    static string digitsOnly(const string &text) {
+        string out;
+        for (unsigned char c : text) {
+            if (isdigit(c)) out.push_back(static_cast<char>(c));
+        }
+        return out;
+    }
+
+public:
+    void clear() {
+        arena.clear();
+        entries.clear();
+        pending.clear();
+        removed.clear();
+    }
+    
+    // Defer sorting while loading many accounts; finishBulkLoad sorts once
+    void beginBulkLoad() { bulkLoading = true; }
+    
+    void finishBulkLoad() {
+        bulkLoading = false;
+        merge();
+    }
+    
+    void add(int accountNumber, const string &name, const string &email, const string &phone) {
+        // Index the full name and every word suffix so "smith" finds "John Smith"
+        string normalizedName = normalizeText(name);
+        addKey(normalizedName, accountNumber);
+        for (size_t pos = normalizedName.find(' '); pos != string::npos; pos = normalizedName.find(' ', pos + 1)) {
+            addKey(normalizedName.substr(pos + 1), accountNumber);
+        }
+        
+        string normalizedEmail = email;
+        transform(normalizedEmail.begin(), normalizedEmail.end(), normalizedEmail.begin(),
+                  [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        addKey(normalizedEmail, accountNumber);
+        // Index the full number and its trailing digits so a local number
+        // matches without the country or area code
+        string phoneDigits = digitsOnly(phone);
+        addKey(phoneDigits, accountNumber);
+        for (size_t start = 1; start + MIN_PHONE_SUFFIX <= phoneDigits.size(); start++) {
+            addKey(phoneDigits.substr(start), accountNumber);
+        }
+        
+        removed.erase(accountNumber);
+        if (!bulkLoading && pending.size() >= MERGE_THRESHOLD) merge();
+    }
+    
+    void remove(int accountNumber) {
+        removed.insert(accountNumber);
+    }
+    
+    size_t size() const { return entries.size() + pending.size(); }
+    
+    // Up to limit distinct accounts whose name, email or phone starts with query,
+    // in key order
+    vector<int> search(const string &query, size_t limit) const {
+        vector<string> prefixes;
+        string text = normalizeText(query);
+        if (!text.empty()) prefixes.push_back(text);
+        string lowered = query;
+        transform(lowered.begin(), lowered.end(), lowered.begin(),
+                  [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        if (lowered.find('@') != string::npos) prefixes.push_back(lowered);
+        string digits = digitsOnly(query);
+        if (!digits.empty() && digits != text) prefixes.push_back(digits);
+        
+        vector<pair<string_view, int>> candidates;
+        for (const string &prefix : prefixes) {
+            auto startsWith = [&prefix](string_view key) { return key.compare(0, prefix.size(), prefix) == 0; };
+            
+            auto it = lower_bound(entries.begin(), entries.end(), prefix,
+                                  [this](const Entry &entry, const string &value) { return keyOf(entry) < value; });
+            vector<int> taken;
+            for (; it != entries.end() && taken.size() < limit && startsWith(keyOf(*it)); ++it) {
+                if (removed.count(it->accountNumber)) continue;
+                candidates.emplace_back(keyOf(*it), it->accountNumber);
+                if (find(taken.begin(), taken.end(), it->accountNumber) == taken.end()) {
+                    taken.push_back(it->accountNumber);
+                }
+            }
+            for (const Entry &entry : pending) {
+                if (!removed.count(entry.accountNumber) && startsWith(keyOf(entry))) {
+                    candidates.emplace_back(keyOf(entry), entry.accountNumber);
+                }
+            }
+        }
+        
+        sort(candidates.begin(), candidates.end());
+        vector<int> results;
+        for (const auto &candidate : candidates) {
+            if (results.size() >= limit) break;
+            if (find(results.begin(), results.end(), candidate.second) == results.end()) {
+                results.push_back(candidate.second);
+            }
+        }
+        return results;
+    }
+};
+
+// Rolling sum over a window of BUCKETS buckets of BUCKET_SECONDS each. A
+// bucket is reset lazily when its slot is reused for a newer interval. The sum
+// covers the current partial bucket plus the BUCKETS before it, so it always
+// spans at least the full window and errs towards over-counting, never under.
+template <size_t BUCKETS, long long BUCKET_SECONDS>
+class SlidingWindowCounter {
+private:
+    static const size_t SLOTS = BUCKETS + 1; // Extra slot keeps the oldest partial bucket
+    
+    long long totals[SLOTS] = {};
+    long long intervals[SLOTS] = {};
+
+public:
+    void add(long long timestamp, long long amount) {
+        long long interval = timestamp / BUCKET_SECONDS;
+        size_t slot = static_cast<size_t>(interval % SLOTS);
+        if (intervals[slot] != interval) {
+            intervals[slot] = interval;
+            totals[slot] = 0;
+        }
+        totals[slot] += amount;
+    }
+    
+    long long sum(long long now) const {
+        long long current = now / BUCKET_SECONDS;
+        long long total = 0;
+        for (size_t i = 0; i < SLOTS; i++) {
+            if (intervals[i] >= current - static_cast<long long>(BUCKETS) && intervals[i] <= current) {
+                total += totals[i];
+            }
+        }
+        return total;
+    }
+};
+
+// Hourly and daily withdrawal/transfer limits. Amounts are in cents; a limit
+// of 0 means unlimited, -1 in an override means "use the account type default".
+struct LimitSet {
+    long long hourlyWithdrawal;
+    long long dailyWithdrawal;
+    long long hourlyTransfer;
+    long long dailyTransfer;
+};
+
+// In-memory limits engine. Per-account counters are seeded from the recent
+// ledger at startup and updated on every posting, so checks never query MySQL.
+class TransactionLimits {
+public:
+    enum Kind { WITHDRAWAL = 0, TRANSFER = 1 };
+
+private:
+    struct AccountCounters {
+        SlidingWindowCounter<12, 300> hourly[2];  // 5-minute buckets
+        SlidingWindowCounter<24, 3600> daily[2];  // 1-hour buckets
+        long long lastPosting = 0;
+    };
+    
+    static const long long WINDOW_SECONDS = 24 * 3600; // Longest window tracked
+    static const long long SWEEP_SECONDS = 3600;
+    
+    unordered_map<int, AccountCounters> counters;
+    unordered_map<int, LimitSet> overrides;
+    long long lastSweep = 0;
+    
+    // Drop accounts with no posting inside the daily window; their counters
+    // would sum to zero anyway
+    void sweep(long long now) {
+        for (auto it = counters.begin(); it != counters.end();) {
+            if (it->second.lastPosting <= now - WINDOW_SECONDS) {
+                it = counters.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        lastSweep = now;
+    }
+    
+    static long long toCents(double amount) {
+        return llround(amount * 100);
+    }
+    
+    static LimitSet defaultsFor(const string &accountType) {
+        if (accountType == "Current") {
+            return {toCents(LimitConfig::CURRENT_HOURLY_WITHDRAWAL), toCents(LimitConfig::CURRENT_DAILY_WITHDRAWAL),
+                    toCents(LimitConfig::CURRENT_HOURLY_TRANSFER), toCents(LimitConfig::CURRENT_DAILY_TRANSFER)};
+        }
+        return {toCents(LimitConfig::SAVINGS_HOURLY_WITHDRAWAL), toCents(LimitConfig::SAVINGS_DAILY_WITHDRAWAL),
+                toCents(LimitConfig::SAVINGS_HOURLY_TRANSFER), toCents(LimitConfig::SAVINGS_DAILY_TRANSFER)};
+    }
+    
+    LimitSet limitsFor(int accountNumber, const string &accountType) const {
+        LimitSet limits = defaultsFor(accountType);
+        auto it = overrides.find(accountNumber);
+        if (it != overrides.end()) {
+            const LimitSet &custom = it->second;
+            if (custom.hourlyWithdrawal >= 0) limits.hourlyWithdrawal = custom.hourlyWithdrawal;
+            if (custom.dailyWithdrawal >= 0) limits.dailyWithdrawal = custom.dailyWithdrawal;
+            if (custom.hourlyTransfer >= 0) limits.hourlyTransfer = custom.hourlyTransfer;
+            if (custom.dailyTransfer >= 0) limits.dailyTransfer = custom.dailyTransfer;
+        }
+        return limits;
+    }
+
+public:
+    void clear() {
+        counters.clear();
+        overrides.clear();
+        lastSweep = 0;
+    }
+    
+    void setOverride(int accountNumber, const LimitSet &limits) {
+        overrides[accountNumber] = limits;
+    }
+    
+    // Returns false and fills reason if amount would exceed an hourly or daily limit
+    bool check(int accountNumber, const string &accountType, Kind kind, double amount,
+               long long now, string &reason) const {
+        LimitSet limits = limitsFor(accountNumber, accountType);
+        long long hourlyLimit = (kind == WITHDRAWAL) ? limits.hourlyWithdrawal : limits.hourlyTransfer;
+        long long dailyLimit = (kind == WITHDRAWAL) ? limits.dailyWithdrawal : limits.dailyTransfer;
+        long long cents = toCents(amount);
+        
+        long long hourlyUsed = 0, dailyUsed = 0;
+        auto it = counters.find(accountNumber);
+        if (it != counters.end()) {
+            hourlyUsed = it->second.hourly[kind].sum(now);
+            dailyUsed = it->second.daily[kind].sum(now);
+        }
+        
+        const char *label = (kind == WITHDRAWAL) ? "withdrawal" : "transfer";
+        ostringstream message;
+        message << fixed << setprecision(2);
+        if (hourlyLimit > 0 && hourlyUsed + cents > hourlyLimit) {
+            message << "Hourly " << label << " limit of $" << hourlyLimit / 100.0
+                    << " exceeded! Remaining this hour: $" << max(0LL, hourlyLimit - hourlyUsed) / 100.0;
+            reason = message.str();
+            return false;
+        }
+        if (dailyLimit > 0 && dailyUsed + cents > dailyLimit) {
+            message << "Daily " << label << " limit of $" << dailyLimit / 100.0
+                    << " exceeded! Remaining today: $" << max(0LL, dailyLimit - dailyUsed) / 100.0;
+            reason = message.str();
+            return false;
+        }
+        return true;
+    }
+    
+    void record(int accountNumber, Kind kind, double amount, long long timestamp) {
+        if (timestamp - lastSweep >= SWEEP_SECONDS) sweep(timestamp);
+        
+        AccountCounters &accountCounters = counters[accountNumber];
+        accountCounters.hourly[kind].add(timestamp, toCents(amount));
+        accountCounters.daily[kind].add(timestamp, toCents(amount));
+        accountCounters.lastPosting = max(accountCounters.lastPosting, timestamp);
+    }
+};
+
 // Main Banking System class
 class BankingSystem {
 private:
     sql::mysql::MySQL_Driver *driver;
     unique_ptr<sql::Connection> conn;
+    unique_ptr<sql::Connection> replicaConn;
+    string lastWritePosition; // Primary GTID set the replica must reach before serving reads
+    time_t replicaRetryAt = 0; // When to try reconnecting after a replica failure
+    bool replicaDisabled = false; // Set when GTIDs are unavailable on the primary
+    
+    // Statement and its result set; the result set must not outlive the
+    // statement, so it is declared last and destroyed first
+    struct QueryResult {
+        unique_ptr<sql::Statement> stmt;
+        unique_ptr<sql::PreparedStatement> pstmt;
+        unique_ptr<sql::ResultSet> res;
+    };
+    vector<pair<string, SegmentHeader>> archivedSegments; // Newest first
+    AccountSearchIndex searchIndex;
+    TransactionLimits limits;
     
     // Database connection
     bool connectToDatabase() {
@@ -168,11 +1077,40 @@ private:
                                                                DatabaseConfig::USER, 
                                                                DatabaseConfig::PASSWORD));
             conn->setSchema(DatabaseConfig::DATABASE);
-            return true;
         } catch (sql::SQLException &e) {
             cerr << "Database connection failed: " << e.what() << endl;
             return false;
         }
+        
+        // A missing replica is not fatal; reads simply stay on the primary
+        if (!DatabaseConfig::REPLICA_HOST.empty()) {
+            connectReplica();
+        }
+        return true;
+    }
+    
+    void connectReplica() {
+        try {
+            replicaConn = unique_ptr<sql::Connection>(driver->connect(DatabaseConfig::REPLICA_HOST,
+                                                                      DatabaseConfig::REPLICA_USER,
+                                                                      DatabaseConfig::REPLICA_PASSWORD));
+            replicaConn->setSchema(DatabaseConfig::DATABASE);
+            unique_ptr<sql::Statement> stmt(replicaConn->createStatement());
+            execute(*stmt, "SET SESSION TRANSACTION READ ONLY");
+        } catch (sql::SQLException &e) {
+            markReplicaDown("Replica connection failed, reading from primary: ", e);
+            return;
+        }
+        
+        // Writes made while the replica was away are unknown, so require it to
+        // reach the primary's current position before serving reads
+        noteWrite();
+    }
+    
+    void markReplicaDown(const char *message, sql::SQLException &e) {
+        cerr << message << e.what() << endl;
+        replicaConn.reset();
+        replicaRetryAt = time(0) + DatabaseConfig::REPLICA_RETRY_SECONDS;
     }
 
 public:
@@ -181,16 +1119,25 @@ public:
             throw runtime_error("Failed to connect to database");
         }
         cout << "Connected to database successfully!" << endl;
+        
+        ensureLedgerPartitions();
+        loadArchiveIndex();
+        rebuildSearchIndex();
+        loadTransactionLimits();
     }
     
     ~BankingSystem() {
         if (conn) {
             conn->close();
         }
+        if (TraceConfig::SAMPLE_RATE > 0.0) {
+            exportTrace();
+        }
     }
     
     // Create new account
     bool createAccount() {
+        TraceSpan span("createAccount");
         try {
             string name, phone, email, address;
             int type;
@@ -231,7 +1178,7 @@ public:
             
             // Prepare SQL statement
             unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("INSERT INTO accounts (account_holder, account_type, balance, phone_number, email, address) VALUES (?, ?, ?, ?, ?, ?)")
+                prepare(conn.get(), "INSERT INTO accounts (account_holder, account_type, balance, phone_number, email, address) VALUES (?, ?, ?, ?, ?, ?)")
             );
             
             pstmt->setString(1, name);
@@ -241,20 +1188,22 @@ public:
             pstmt->setString(5, email);
             pstmt->setString(6, address);
             
-            if (pstmt->executeUpdate()) {
+            if (executeUpdate(*pstmt)) {
                 cout << "Account created successfully!" << endl;
                 
                 // Get the generated account number
                 unique_ptr<sql::Statement> stmt(conn->createStatement());
-                unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT LAST_INSERT_ID() as id"));
+                unique_ptr<sql::ResultSet> res(executeQuery(*stmt, "SELECT LAST_INSERT_ID() as id"));
                 if (res->next()) {
                     int accNo = res->getInt("id");
                     cout << "Your Account Number is: " << accNo << endl;
+                    searchIndex.add(accNo, name, email, phone);
                     
                     // Record initial deposit transaction
                     recordTransaction(accNo, "Deposit", initialDeposit, initialDeposit, 
                                     "Initial Deposit");
                 }
+                noteWrite();
                 return true;
             }
         } catch (sql::SQLException &e) {
@@ -265,6 +1214,7 @@ public:
     
     // Deposit money
     bool deposit(int accountNumber, double amount) {
+        TraceSpan span("deposit");
         try {
             if (amount <= 0) {
                 cout << "Invalid amount!" << endl;
@@ -279,15 +1229,16 @@ public:
             
             // Update balance
             unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("UPDATE accounts SET balance = ? WHERE account_number = ?")
+                prepare(conn.get(), "UPDATE accounts SET balance = ? WHERE account_number = ?")
             );
             pstmt->setDouble(1, newBalance);
             pstmt->setInt(2, accountNumber);
             
-            if (pstmt->executeUpdate()) {
+            if (executeUpdate(*pstmt)) {
                 // Record transaction
                 recordTransaction(accountNumber, "Deposit", amount, newBalance, 
                                 "Cash Deposit");
+                noteWrite();
                 cout << "Deposit successful! New balance: $" << fixed << setprecision(2) 
                      << newBalance << endl;
                 return true;
@@ -300,6 +1251,7 @@ public:
     
     // Withdraw money
     bool withdraw(int accountNumber, double amount) {
+        TraceSpan span("withdraw");
         try {
             if (amount <= 0) {
                 cout << "Invalid amount!" << endl;
@@ -318,6 +1270,13 @@ public:
                 }
             }
             
+            // Check hourly/daily withdrawal limits
+            string limitReason;
+            if (!limits.check(accountNumber, accType, TransactionLimits::WITHDRAWAL, amount, time(0), limitReason)) {
+                cout << limitReason << endl;
+                return false;
+            }
+            
             if (currentBalance < amount) {
                 cout << "Insufficient balance!" << endl;
                 return false;
@@ -327,15 +1286,17 @@ public:
             
             // Update balance
             unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("UPDATE accounts SET balance = ? WHERE account_number = ?")
+                prepare(conn.get(), "UPDATE accounts SET balance = ? WHERE account_number = ?")
             );
             pstmt->setDouble(1, newBalance);
             pstmt->setInt(2, accountNumber);
             
-            if (pstmt->executeUpdate()) {
+            if (executeUpdate(*pstmt)) {
                 // Record transaction
                 recordTransaction(accountNumber, "Withdrawal", amount, newBalance, 
                                 "Cash Withdrawal");
+                limits.record(accountNumber, TransactionLimits::WITHDRAWAL, amount, time(0));
+                noteWrite();
                 cout << "Withdrawal successful! New balance: $" << fixed << setprecision(2) 
                      << newBalance << endl;
                 return true;
@@ -348,6 +1309,7 @@ public:
     
     // Transfer money between accounts
     bool transfer(int fromAccount, int toAccount, double amount) {
+        TraceSpan span("transfer");
         try {
             if (amount <= 0) {
                 cout << "Invalid amount!" << endl;
@@ -377,6 +1339,13 @@ public:
                 }
             }
             
+            // Check hourly/daily transfer limits
+            string limitReason;
+            if (!limits.check(fromAccount, fromAccType, TransactionLimits::TRANSFER, amount, time(0), limitReason)) {
+                cout << limitReason << endl;
+                return false;
+            }
+            
             if (fromBalance < amount) {
                 cout << "Insufficient balance in source account!" << endl;
                 return false;
@@ -392,19 +1361,19 @@ public:
             try {
                 // Update source account
                 unique_ptr<sql::PreparedStatement> pstmt1(
-                    conn->prepareStatement("UPDATE accounts SET balance = ? WHERE account_number = ?")
+                    prepare(conn.get(), "UPDATE accounts SET balance = ? WHERE account_number = ?")
                 );
                 pstmt1->setDouble(1, newFromBalance);
                 pstmt1->setInt(2, fromAccount);
-                pstmt1->executeUpdate();
+                executeUpdate(*pstmt1);
                 
                 // Update destination account
                 unique_ptr<sql::PreparedStatement> pstmt2(
-                    conn->prepareStatement("UPDATE accounts SET balance = ? WHERE account_number = ?")
+                    prepare(conn.get(), "UPDATE accounts SET balance = ? WHERE account_number = ?")
                 );
                 pstmt2->setDouble(1, newToBalance);
                 pstmt2->setInt(2, toAccount);
-                pstmt2->executeUpdate();
+                executeUpdate(*pstmt2);
                 
                 // Record transactions
                 string desc = "Transfer to account " + to_string(toAccount);
@@ -414,8 +1383,10 @@ public:
                 recordTransaction(toAccount, "Transfer", amount, newToBalance, desc);
                 
                 // Commit transaction
-                conn->commit();
+                commit();
                 conn->setAutoCommit(true);
+                limits.record(fromAccount, TransactionLimits::TRANSFER, amount, time(0));
+                noteWrite();
                 
                 cout << "Transfer successful!" << endl;
                 cout << "New balance in account " << fromAccount << ": $" 
@@ -423,7 +1394,7 @@ public:
                 return true;
                 
             } catch (sql::SQLException &e) {
-                conn->rollback();
+                rollback();
                 conn->setAutoCommit(true);
                 throw;
             }
@@ -436,13 +1407,20 @@ public:
     
     // Display account information
     void displayAccountInfo(int accountNumber) {
+        TraceSpan span("displayAccountInfo");
         try {
-            unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("SELECT * FROM accounts WHERE account_number = ?")
-            );
-            pstmt->setInt(1, accountNumber);
-            
-            unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            QueryResult result = readQuery([&](sql::Connection *reader) {
+                QueryResult r;
+                unique_ptr<sql::PreparedStatement> pstmt(
+                    prepare(reader, "SELECT * FROM accounts WHERE account_number = ?")
+                );
+                pstmt->setInt(1, accountNumber);
+                
+                r.res.reset(executeQuery(*pstmt));
+                r.pstmt = move(pstmt);
+                return r;
+            });
+            unique_ptr<sql::ResultSet> &res = result.res;
             
             if (res->next()) {
                 Account* acc = nullptr;
@@ -478,34 +1456,33 @@ public:
     
     // Display transaction history
     void displayTransactionHistory(int accountNumber) {
+        TraceSpan span("displayTransactionHistory");
         try {
-            unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("SELECT * FROM transactions WHERE account_number = ? ORDER BY transaction_date DESC LIMIT 10")
-            );
-            pstmt->setInt(1, accountNumber);
-            
-            unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            vector<LedgerRow> rows = loadTransactionHistory(accountNumber, 0, LLONG_MAX, 10);
             
             cout << "\n=== Last 10 Transactions ===" << endl;
-            bool found = false;
+            displayLedgerRows(rows);
             
-            while (res->next()) {
-                found = true;
-                Transaction txn(
-                    res->getInt("account_number"),
-                    res->getString("transaction_type"),
-                    res->getDouble("amount"),
-                    res->getDouble("balance_after"),
-                    res->getString("description")
-                );
-                txn.transactionId = res->getInt("transaction_id");
-                txn.transactionDate = res->getString("transaction_date");
-                txn.displayTransaction();
-            }
+        } catch (sql::SQLException &e) {
+            cerr << "Error displaying transaction history: " << e.what() << endl;
+        }
+    }
+    
+    // Display transaction history within a date range, including archived months
+    void displayTransactionHistory(int accountNumber, const string &fromDate, const string &toDate) {
+        TraceSpan span("displayTransactionHistory");
+        long long fromTs, toTs;
+        if (!parseDate(fromDate, fromTs) || !parseDate(toDate, toTs)) {
+            cout << "Invalid date! Use YYYY-MM-DD." << endl;
+            return;
+        }
+        toTs += 24 * 60 * 60; // Include the whole end day
+        
+        try {
+            vector<LedgerRow> rows = loadTransactionHistory(accountNumber, fromTs, toTs, 0);
             
-            if (!found) {
-                cout << "No transactions found for this account." << endl;
-            }
+            cout << "\n=== Transactions from " << fromDate << " to " << toDate << " ===" << endl;
+            displayLedgerRows(rows);
             
         } catch (sql::SQLException &e) {
             cerr << "Error displaying transaction history: " << e.what() << endl;
@@ -514,11 +1491,17 @@ public:
     
     // Get all accounts
     void listAllAccounts() {
+        TraceSpan span("listAllAccounts");
         try {
-            unique_ptr<sql::Statement> stmt(conn->createStatement());
-            unique_ptr<sql::ResultSet> res(stmt->executeQuery(
-                "SELECT account_number, account_holder, account_type, balance, status FROM accounts"
-            ));
+            QueryResult result = readQuery([&](sql::Connection *reader) {
+                QueryResult r;
+                r.stmt.reset(reader->createStatement());
+                r.res.reset(executeQuery(*r.stmt,
+                    "SELECT account_number, account_holder, account_type, balance, status FROM accounts"
+                ));
+                return r;
+            });
+            unique_ptr<sql::ResultSet> &res = result.res;
             
             cout << "\n=== All Accounts ===" << endl;
             cout << left << setw(15) << "Account No" 
@@ -543,12 +1526,19 @@ public:
     
     // Calculate and display interest for all savings accounts
     void calculateInterest() {
+        TraceSpan span("calculateInterest");
         try {
-            unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("SELECT * FROM accounts WHERE account_type = 'Savings'")
-            );
-            
-            unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            QueryResult result = readQuery([&](sql::Connection *reader) {
+                QueryResult r;
+                unique_ptr<sql::PreparedStatement> pstmt(
+                    prepare(reader, "SELECT * FROM accounts WHERE account_type = 'Savings'")
+                );
+                
+                r.res.reset(executeQuery(*pstmt));
+                r.pstmt = move(pstmt);
+                return r;
+            });
+            unique_ptr<sql::ResultSet> &res = result.res;
             
             cout << "\n=== Interest Calculation for Savings Accounts ===" << endl;
             
@@ -572,6 +1562,7 @@ public:
     
     // Close account
     bool closeAccount(int accountNumber) {
+        TraceSpan span("closeAccount");
         try {
             // Check if account exists and has zero balance
             double balance = getBalance(accountNumber);
@@ -583,12 +1574,14 @@ public:
             }
             
             unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("UPDATE accounts SET status = 'Closed' WHERE account_number = ?")
+                prepare(conn.get(), "UPDATE accounts SET status = 'Closed' WHERE account_number = ?")
             );
             pstmt->setInt(1, accountNumber);
             
-            if (pstmt->executeUpdate()) {
+            if (executeUpdate(*pstmt)) {
                 cout << "Account closed successfully!" << endl;
+                searchIndex.remove(accountNumber);
+                noteWrite();
                 return true;
             }
             
@@ -598,16 +1591,518 @@ public:
         return false;
     }
 
+    // As-you-type lookup by holder name, email or phone number
+    void searchAccounts(const string &query) {
+        TraceSpan span("searchAccounts");
+        vector<int> matches = searchIndex.search(query, 10);
+        if (matches.empty()) {
+            cout << "No matching accounts found." << endl;
+            return;
+        }
+        
+        try {
+            string placeholders;
+            for (size_t i = 0; i < matches.size(); i++) {
+                placeholders += (i == 0) ? "?" : ", ?";
+            }
+            QueryResult result = readQuery([&](sql::Connection *reader) {
+                QueryResult r;
+                unique_ptr<sql::PreparedStatement> pstmt(prepare(reader,
+                    "SELECT account_number, account_holder, email, phone_number, status FROM accounts "
+                    "WHERE account_number IN (" + placeholders + ")"
+                ));
+                for (size_t i = 0; i < matches.size(); i++) {
+                    pstmt->setInt(static_cast<unsigned int>(i + 1), matches[i]);
+                }
+                
+                r.res.reset(executeQuery(*pstmt));
+                r.pstmt = move(pstmt);
+                return r;
+            });
+            unique_ptr<sql::ResultSet> &res = result.res;
+            
+            map<int, string> rows;
+            while (res->next()) {
+                ostringstream row;
+                row << left << setw(15) << res->getInt("account_number")
+                    << setw(25) << res->getString("account_holder")
+                    << setw(30) << res->getString("email")
+                    << setw(18) << res->getString("phone_number")
+                    << res->getString("status");
+                rows[res->getInt("account_number")] = row.str();
+            }
+            
+            cout << "\n=== Search Results ===" << endl;
+            cout << left << setw(15) << "Account No"
+                 << setw(25) << "Holder Name"
+                 << setw(30) << "Email"
+                 << setw(18) << "Phone"
+                 << "Status" << endl;
+            cout << string(95, '-') << endl;
+            
+            // Keep the index's ranking
+            for (int accNo : matches) {
+                auto it = rows.find(accNo);
+                if (it != rows.end()) cout << it->second << endl;
+            }
+            
+        } catch (sql::SQLException &e) {
+            cerr << "Error searching accounts: " << e.what() << endl;
+        }
+    }
+    
+    // Dump sampled request spans as Chrome trace-event JSON
+    bool exportTrace() {
+        return Tracer::writeChromeTrace(TraceConfig::OUTPUT_FILE);
+    }
+    
+    // Move ledger partitions older than LIVE_MONTHS into archive segment files
+    bool archiveOldTransactions() {
+        TraceSpan span("archiveOldTransactions");
+        ensureLedgerPartitions(); // Long-running processes would otherwise fill pmax
+        
+        try {
+            unique_ptr<sql::Statement> stmt(conn->createStatement());
+            unique_ptr<sql::ResultSet> res(executeQuery(*stmt,
+                "SELECT UNIX_TIMESTAMP(DATE_FORMAT(NOW() - INTERVAL " + to_string(LedgerConfig::LIVE_MONTHS) +
+                " MONTH, '%Y-%m-01')) AS cutoff"
+            ));
+            if (!res->next()) return false;
+            long long cutoff = res->getInt64("cutoff");
+            
+            filesystem::create_directories(LedgerConfig::ARCHIVE_DIR);
+            int archived = 0;
+            
+            for (const auto &partition : getLedgerPartitions()) {
+                // Only partitions whose upper bound is at or before the cutoff
+                if (partition.second == "MAXVALUE" || stoll(partition.second) > cutoff) continue;
+                
+                // Stream the partition so only one copy of the month is held in memory
+                vector<LedgerRow> rows;
+                {
+                    unique_ptr<sql::Statement> selectStmt(conn->createStatement());
+                    selectStmt->setResultSetType(sql::ResultSet::TYPE_FORWARD_ONLY);
+                    unique_ptr<sql::ResultSet> rowsRes(executeQuery(*selectStmt,
+                        "SELECT " + string(LEDGER_COLUMNS) + " FROM transactions PARTITION (" + partition.first + ")"
+                    ));
+                    while (rowsRes->next()) {
+                        rows.push_back(readLedgerRow(*rowsRes));
+                    }
+                }
+                
+                long long rowCount = static_cast<long long>(rows.size());
+                if (rowCount > 0) {
+                    string path = LedgerConfig::ARCHIVE_DIR + "/" + partition.first + ".seg";
+                    SegmentHeader header;
+                    if (!LedgerSegment::write(path, move(rows)) || !LedgerSegment::readHeader(path, header) ||
+                        header.rowCount != rowCount) {
+                        cerr << "Error archiving partition " << partition.first << endl;
+                        return false;
+                    }
+                }
+                
+                unique_ptr<sql::Statement> dropStmt(conn->createStatement());
+                execute(*dropStmt, "ALTER TABLE transactions DROP PARTITION " + partition.first);
+                noteWrite(); // Replica reads must not see the dropped rows alongside the segment
+                archived++;
+            }
+            
+            loadArchiveIndex();
+            cout << "Archived " << archived << " ledger partition(s)." << endl;
+            return true;
+            
+        } catch (sql::SQLException &e) {
+            cerr << "Error archiving transactions: " << e.what() << endl;
+        } catch (filesystem::filesystem_error &e) {
+            cerr << "Error archiving transactions: " << e.what() << endl;
+        }
+        return false;
+    }
+
 private:
+    // Columns selected for ledger reads; amounts in cents and dates as epoch seconds
+    static constexpr const char *LEDGER_COLUMNS =
+        "transaction_id, account_number, transaction_type, "
+        "CAST(amount * 100 AS SIGNED) AS amount_cents, "
+        "CAST(balance_after * 100 AS SIGNED) AS balance_cents, "
+        "UNIX_TIMESTAMP(transaction_date) AS ts, description";
+    
+    static LedgerRow readLedgerRow(sql::ResultSet &res) {
+        LedgerRow row;
+        row.transactionId = res.getInt64("transaction_id");
+        row.accountNumber = res.getInt("account_number");
+        row.transactionType = res.getString("transaction_type");
+        row.amountCents = res.getInt64("amount_cents");
+        row.balanceAfterCents = res.getInt64("balance_cents");
+        row.timestamp = res.getInt64("ts");
+        row.description = res.getString("description");
+        return row;
+    }
+    
+    static string formatTimestamp(long long timestamp) {
+        time_t t = static_cast<time_t>(timestamp);
+        char buffer[20];
+        strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", localtime(&t));
+        return buffer;
+    }
+    
+    static bool parseDate(const string &date, long long &timestamp) {
+        tm t = {};
+        istringstream in(date);
+        in >> get_time(&t, "%Y-%m-%d");
+        if (in.fail()) return false;
+        t.tm_isdst = -1;
+        timestamp = mktime(&t);
+        return true;
+    }
+    
+    void displayLedgerRows(const vector<LedgerRow> &rows) {
+        for (const LedgerRow &row : rows) {
+            Transaction txn(row.accountNumber, row.transactionType, row.amountCents / 100.0,
+                            row.balanceAfterCents / 100.0, row.description);
+            txn.transactionId = row.transactionId;
+            txn.transactionDate = formatTimestamp(row.timestamp);
+            txn.displayTransaction();
+        }
+        
+        if (rows.empty()) {
+            cout << "No transactions found for this account." << endl;
+        }
+    }
+    
+    // Newest-first history for [fromTs, toTs) across the live table and
+    // archived segments; limit 0 means no limit
+    vector<LedgerRow> loadTransactionHistory(int accountNumber, long long fromTs, long long toTs, size_t limit) {
+        TraceSpan span("loadTransactionHistory");
+        string query = "SELECT " + string(LEDGER_COLUMNS) +
+                       " FROM transactions WHERE account_number = ? AND transaction_date >= FROM_UNIXTIME(?)";
+        if (toTs != LLONG_MAX) query += " AND transaction_date < FROM_UNIXTIME(?)";
+        query += " ORDER BY transaction_date DESC, transaction_id DESC";
+        if (limit > 0) query += " LIMIT " + to_string(limit);
+        
+        QueryResult result = readQuery([&](sql::Connection *reader) {
+            QueryResult r;
+            unique_ptr<sql::PreparedStatement> pstmt(prepare(reader, query));
+            pstmt->setInt(1, accountNumber);
+            pstmt->setInt64(2, fromTs);
+            if (toTs != LLONG_MAX) pstmt->setInt64(3, toTs);
+            
+            r.res.reset(executeQuery(*pstmt));
+            r.pstmt = move(pstmt);
+            return r;
+        });
+        unique_ptr<sql::ResultSet> &res = result.res;
+        
+        vector<LedgerRow> rows;
+        while (res->next()) {
+            rows.push_back(readLedgerRow(*res));
+        }
+        
+        // Archived months are all older than the live table, newest segment first
+        for (const auto &segment : archivedSegments) {
+            if (limit > 0 && rows.size() >= limit) break;
+            if (!segment.second.overlaps(accountNumber, fromTs, toTs)) continue;
+            
+            size_t firstNew = rows.size();
+            if (!LedgerSegment::read(segment.first, segment.second, accountNumber, fromTs, toTs, rows)) {
+                rows.resize(firstNew);
+                continue;
+            }
+            sort(rows.begin() + firstNew, rows.end(), [](const LedgerRow &a, const LedgerRow &b) {
+                if (a.timestamp != b.timestamp) return a.timestamp > b.timestamp;
+                return a.transactionId > b.transactionId;
+            });
+        }
+        
+        if (limit > 0 && rows.size() > limit) rows.resize(limit);
+        return rows;
+    }
+    
+    // (name, upper bound) of each ledger partition in order
+    vector<pair<string, string>> getLedgerPartitions() {
+        unique_ptr<sql::Statement> stmt(conn->createStatement());
+        unique_ptr<sql::ResultSet> res(executeQuery(*stmt,
+            "SELECT PARTITION_NAME, PARTITION_DESCRIPTION FROM information_schema.PARTITIONS "
+            "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = 'transactions' AND PARTITION_NAME IS NOT NULL "
+            "ORDER BY PARTITION_ORDINAL_POSITION"
+        ));
+        
+        vector<pair<string, string>> partitions;
+        while (res->next()) {
+            partitions.emplace_back(res->getString("PARTITION_NAME"), res->getString("PARTITION_DESCRIPTION"));
+        }
+        return partitions;
+    }
+    
+    // Split pmax so every month from the newest existing partition through
+    // next month has its own partition, filling gaps left while not running
+    void ensureLedgerPartitions() {
+        TraceSpan span("ensureLedgerPartitions");
+        try {
+            bool hasMax = false;
+            int lastMonthIndex = -1; // year * 12 + (month - 1) of the newest monthly partition
+            for (const auto &partition : getLedgerPartitions()) {
+                int year, month;
+                if (partition.first == "pmax") {
+                    hasMax = true;
+                } else if (sscanf(partition.first.c_str(), "p%4d_%2d", &year, &month) == 2) {
+                    lastMonthIndex = max(lastMonthIndex, year * 12 + (month - 1));
+                }
+            }
+            if (!hasMax) return;
+            
+            time_t now = time(0);
+            tm local = *localtime(&now);
+            int currentMonthIndex = (local.tm_year + 1900) * 12 + local.tm_mon;
+            int firstMonthIndex = (lastMonthIndex < 0) ? currentMonthIndex : lastMonthIndex + 1;
+            
+            for (int monthIndex = firstMonthIndex; monthIndex <= currentMonthIndex + 1; monthIndex++) {
+                char name[16], bound[32];
+                snprintf(name, sizeof(name), "p%04d_%02d", monthIndex / 12, monthIndex % 12 + 1);
+                snprintf(bound, sizeof(bound), "%04d-%02d-01 00:00:00", (monthIndex + 1) / 12, (monthIndex + 1) % 12 + 1);
+                
+                unique_ptr<sql::Statement> stmt(conn->createStatement());
+                execute(*stmt, string("ALTER TABLE transactions REORGANIZE PARTITION pmax INTO (") +
+                              "PARTITION " + name + " VALUES LESS THAN (UNIX_TIMESTAMP('" + bound + "')), " +
+                              "PARTITION pmax VALUES LESS THAN MAXVALUE)");
+            }
+        } catch (sql::SQLException &e) {
+            cerr << "Error maintaining ledger partitions: " << e.what() << endl;
+        }
+    }
+    
+    // Load the search index from a streaming scan of open accounts
+    void rebuildSearchIndex() {
+        TraceSpan span("rebuildSearchIndex");
+        searchIndex.clear();
+        searchIndex.beginBulkLoad();
+        
+        try {
+            unique_ptr<sql::Statement> stmt(conn->createStatement());
+            stmt->setResultSetType(sql::ResultSet::TYPE_FORWARD_ONLY); // Unbuffered, row at a time
+            unique_ptr<sql::ResultSet> res(executeQuery(*stmt,
+                "SELECT account_number, account_holder, email, phone_number FROM accounts WHERE status <> 'Closed'"
+            ));
+            
+            while (res->next()) {
+                searchIndex.add(res->getInt("account_number"), res->getString("account_holder"),
+                                res->getString("email"), res->getString("phone_number"));
+            }
+        } catch (sql::SQLException &e) {
+            cerr << "Error building search index: " << e.what() << endl;
+        }
+        
+        searchIndex.finishBulkLoad();
+    }
+    
+    // Seed limit counters from the last day of outgoing postings and load
+    // per-account overrides
+    void loadTransactionLimits() {
+        TraceSpan span("loadTransactionLimits");
+        limits.clear();
+        
+        try {
+            unique_ptr<sql::Statement> stmt(conn->createStatement());
+            stmt->setResultSetType(sql::ResultSet::TYPE_FORWARD_ONLY);
+            unique_ptr<sql::ResultSet> res(executeQuery(*stmt,
+                "SELECT account_number, transaction_type, amount, UNIX_TIMESTAMP(transaction_date) AS ts "
+                "FROM transactions WHERE transaction_date >= NOW() - INTERVAL 1 DAY "
+                "AND (transaction_type = 'Withdrawal' OR "
+                "(transaction_type = 'Transfer' AND description LIKE 'Transfer to%'))"
+            ));
+            while (res->next()) {
+                TransactionLimits::Kind kind = (res->getString("transaction_type") == "Withdrawal")
+                                                   ? TransactionLimits::WITHDRAWAL
+                                                   : TransactionLimits::TRANSFER;
+                limits.record(res->getInt("account_number"), kind, res->getDouble("amount"), res->getInt64("ts"));
+            }
+            
+            unique_ptr<sql::Statement> overrideStmt(conn->createStatement());
+            unique_ptr<sql::ResultSet> overrideRes(executeQuery(*overrideStmt,
+                "SELECT account_number, "
+                "IFNULL(CAST(hourly_withdrawal_limit * 100 AS SIGNED), -1) AS hourly_withdrawal, "
+                "IFNULL(CAST(daily_withdrawal_limit * 100 AS SIGNED), -1) AS daily_withdrawal, "
+                "IFNULL(CAST(hourly_transfer_limit * 100 AS SIGNED), -1) AS hourly_transfer, "
+                "IFNULL(CAST(daily_transfer_limit * 100 AS SIGNED), -1) AS daily_transfer "
+                "FROM account_limits"
+            ));
+            while (overrideRes->next()) {
+                limits.setOverride(overrideRes->getInt("account_number"),
+                                   {overrideRes->getInt64("hourly_withdrawal"), overrideRes->getInt64("daily_withdrawal"),
+                                    overrideRes->getInt64("hourly_transfer"), overrideRes->getInt64("daily_transfer")});
+            }
+        } catch (sql::SQLException &e) {
+            cerr << "Error loading transaction limits: " << e.what() << endl;
+        }
+    }
+    
+    // Cache segment min/max indexes so history queries can skip whole files
+    void loadArchiveIndex() {
+        TraceSpan span("loadArchiveIndex");
+        archivedSegments.clear();
+        
+        // A segment whose partition still exists was written but never dropped
+        // (failed or interrupted archive); its rows are still live
+        vector<pair<string, string>> partitions;
+        try {
+            partitions = getLedgerPartitions();
+        } catch (sql::SQLException &e) {
+            cerr << "Error listing ledger partitions: " << e.what() << endl;
+        }
+        
+        error_code ec;
+        for (const auto &entry : filesystem::directory_iterator(LedgerConfig::ARCHIVE_DIR, ec)) {
+            if (entry.path().extension() != ".seg") continue;
+            
+            string partitionName = entry.path().stem().string();
+            bool stillLive = any_of(partitions.begin(), partitions.end(),
+                                    [&partitionName](const pair<string, string> &partition) {
+                                        return partition.first == partitionName;
+                                    });
+            if (stillLive) continue;
+            
+            SegmentHeader header;
+            if (LedgerSegment::readHeader(entry.path().string(), header)) {
+                archivedSegments.emplace_back(entry.path().string(), header);
+            }
+        }
+        
+        sort(archivedSegments.begin(), archivedSegments.end(),
+             [](const pair<string, SegmentHeader> &a, const pair<string, SegmentHeader> &b) {
+                 return a.second.maxTimestamp > b.second.maxTimestamp;
+             });
+    }
+    
+    // Traced wrappers around connector round trips
+    static sql::PreparedStatement* prepare(sql::Connection *connection, const string &query) {
+        TraceSpan span("prepare");
+        return connection->prepareStatement(query);
+    }
+    
+    static sql::ResultSet* executeQuery(sql::PreparedStatement &pstmt) {
+        TraceSpan span("executeQuery");
+        return pstmt.executeQuery();
+    }
+    
+    static sql::ResultSet* executeQuery(sql::Statement &stmt, const string &query) {
+        TraceSpan span("executeQuery");
+        return stmt.executeQuery(query);
+    }
+    
+    static int executeUpdate(sql::PreparedStatement &pstmt) {
+        TraceSpan span("executeUpdate");
+        return pstmt.executeUpdate();
+    }
+    
+    static bool execute(sql::Statement &stmt, const string &query) {
+        TraceSpan span("execute");
+        return stmt.execute(query);
+    }
+    
+    void commit() {
+        TraceSpan span("commit");
+        conn->commit();
+    }
+    
+    void rollback() {
+        TraceSpan span("rollback");
+        conn->rollback();
+    }
+    
+    // Remember how far the primary has advanced so replica reads can wait for it
+    void noteWrite() {
+        TraceSpan span("noteWrite");
+        if (DatabaseConfig::REPLICA_HOST.empty() || replicaDisabled) return;
+        
+        try {
+            unique_ptr<sql::Statement> stmt(conn->createStatement());
+            unique_ptr<sql::ResultSet> res(executeQuery(*stmt, "SELECT @@GLOBAL.gtid_executed AS position"));
+            lastWritePosition = res->next() ? res->getString("position") : "";
+        } catch (sql::SQLException &e) {
+            // Position unknown; reconnecting later captures it again
+            markReplicaDown("Error reading primary position, reading from primary: ", e);
+            return;
+        }
+        
+        // Without GTIDs we cannot tell whether the replica has our writes
+        if (lastWritePosition.empty()) {
+            cerr << "GTID position unavailable, reading from primary." << endl;
+            replicaConn.reset();
+            replicaDisabled = true;
+        }
+    }
+    
+    // Run a read-only query on the read connection, retrying on the primary
+    // if the replica fails
+    template <typename Query>
+    QueryResult readQuery(Query query) {
+        sql::Connection *reader = readConnection();
+        if (reader != conn.get()) {
+            try {
+                return query(reader);
+            } catch (sql::SQLException &e) {
+                markReplicaDown("Replica query failed, retrying on primary: ", e);
+            }
+        }
+        return query(conn.get());
+    }
+    
+    // Pick the connection for read-only queries: the replica once it has
+    // applied our last write, otherwise the primary
+    sql::Connection* readConnection() {
+        TraceSpan span("readConnection");
+        if (!replicaConn) {
+            if (DatabaseConfig::REPLICA_HOST.empty() || replicaDisabled || time(0) < replicaRetryAt) {
+                return conn.get();
+            }
+            connectReplica();
+            if (!replicaConn) return conn.get();
+        }
+        if (lastWritePosition.empty()) return replicaConn.get();
+        
+        try {
+            // Non-blocking check first so a lagging replica costs one round trip
+            unique_ptr<sql::PreparedStatement> pstmt(
+                prepare(replicaConn.get(), "SELECT GTID_SUBSET(?, @@GLOBAL.gtid_executed) AS caught_up")
+            );
+            pstmt->setString(1, lastWritePosition);
+            
+            unique_ptr<sql::ResultSet> res(executeQuery(*pstmt));
+            if (res->next() && res->getInt("caught_up") == 1) {
+                lastWritePosition.clear();
+                return replicaConn.get();
+            }
+            
+            // Then give it a short bounded wait before using the primary
+            if (DatabaseConfig::REPLICA_MAX_WAIT_SECONDS > 0) {
+                unique_ptr<sql::PreparedStatement> waitStmt(
+                    prepare(replicaConn.get(), "SELECT WAIT_FOR_EXECUTED_GTID_SET(?, ?) AS timed_out")
+                );
+                waitStmt->setString(1, lastWritePosition);
+                waitStmt->setDouble(2, DatabaseConfig::REPLICA_MAX_WAIT_SECONDS);
+                
+                unique_ptr<sql::ResultSet> waitRes(executeQuery(*waitStmt));
+                if (waitRes->next() && waitRes->getInt("timed_out") == 0) {
+                    lastWritePosition.clear();
+                    return replicaConn.get();
+                }
+            }
+        } catch (sql::SQLException &e) {
+            markReplicaDown("Error checking replica position, reading from primary: ", e);
+        }
+        return conn.get();
+    }
+    
     // Helper function to get account balance
     double getBalance(int accountNumber) {
+        TraceSpan span("getBalance");
         try {
             unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("SELECT balance FROM accounts WHERE account_number = ?")
+                prepare(conn.get(), "SELECT balance FROM accounts WHERE account_number = ?")
             );
             pstmt->setInt(1, accountNumber);
             
-            unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            unique_ptr<sql::ResultSet> res(executeQuery(*pstmt));
             
             if (res->next()) {
                 return res->getDouble("balance");
@@ -620,13 +2115,14 @@ private:
     
     // Helper function to get account type
     string getAccountType(int accountNumber) {
+        TraceSpan span("getAccountType");
         try {
             unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("SELECT account_type FROM accounts WHERE account_number = ?")
+                prepare(conn.get(), "SELECT account_type FROM accounts WHERE account_number = ?")
             );
             pstmt->setInt(1, accountNumber);
             
-            unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            unique_ptr<sql::ResultSet> res(executeQuery(*pstmt));
             
             if (res->next()) {
                 return res->getString("account_type");
@@ -640,9 +2136,10 @@ private:
     // Record transaction
     void recordTransaction(int accountNumber, string type, double amount, 
                           double balanceAfter, string description) {
+        TraceSpan span("recordTransaction");
         try {
             unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("INSERT INTO transactions (account_number, transaction_type, amount, balance_after, description) VALUES (?, ?, ?, ?, ?)")
+                prepare(conn.get(), "INSERT INTO transactions (account_number, transaction_type, amount, balance_after, description) VALUES (?, ?, ?, ?, ?)")
             );
             
             pstmt->setInt(1, accountNumber);
@@ -651,7 +2148,7 @@ private:
             pstmt->setDouble(4, balanceAfter);
             pstmt->setString(5, description);
             
-            pstmt->executeUpdate();
+            executeUpdate(*pstmt);
             
         } catch (sql::SQLException &e) {
             cerr << "Error recording transaction: " << e.what() << endl;
@@ -665,6 +2162,7 @@ int main() {
         BankingSystem bank;
         int choice, accountNo, toAccount;
         double amount;
+        string fromDate, toDate, searchQuery;
         
         do {
             cout << "\n=================================" << endl;
@@ -679,6 +2177,10 @@ int main() {
             cout << "7. List All Accounts" << endl;
             cout << "8. Calculate Interest (Savings)" << endl;
             cout << "9. Close Account" << endl;
+            cout << "10. Transaction History by Date Range" << endl;
+            cout << "11. Archive Old Transactions" << endl;
+            cout << "12. Search Accounts" << endl;
+            cout << "13. Export Trace" << endl;
             cout << "0. Exit" << endl;
             cout << "=================================" << endl;
             cout << "Enter your choice: ";
@@ -741,6 +2243,31 @@ int main() {
                     bank.closeAccount(accountNo);
                     break;
                     
+                case 10:
+                    cout << "Enter Account Number: ";
+                    cin >> accountNo;
+                    cout << "Enter Start Date (YYYY-MM-DD): ";
+                    cin >> fromDate;
+                    cout << "Enter End Date (YYYY-MM-DD): ";
+                    cin >> toDate;
+                    bank.displayTransactionHistory(accountNo, fromDate, toDate);
+                    break;
+                    
+                case 11:
+                    bank.archiveOldTransactions();
+                    break;
+                    
+                case 12:
+                    cout << "Enter Name, Email or Phone: ";
+                    cin.ignore();
+                    getline(cin, searchQuery);
+                    bank.searchAccounts(searchQuery);
+                    break;
+                    
+                case 13:
+                    bank.exportTrace();
+                    break;
+                    
                 case 0:
                     cout << "Thank you for using our Banking System!" << endl;
                     break;
@@ -13,13 +13,44 @@ CREATE TABLE accounts (
     status ENUM('Active', 'Inactive', 'Closed') DEFAULT 'Active'
 );
 
+-- Ledger is partitioned by month; the application adds every missing month
+-- after the last partition below through next month, and archives old ones
+-- to segment files. Partitioned tables cannot have
+-- foreign keys, so account_number is validated by the application.
 CREATE TABLE transactions (
-    transaction_id INT PRIMARY KEY AUTO_INCREMENT,
+    transaction_id BIGINT NOT NULL AUTO_INCREMENT,
     account_number INT,
     transaction_type ENUM('Deposit', 'Withdrawal', 'Transfer') NOT NULL,
     amount DECIMAL(15,2) NOT NULL,
     balance_after DECIMAL(15,2),
-    transaction_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    transaction_date TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
     description TEXT,
+    PRIMARY KEY (transaction_id, transaction_date),
+    KEY idx_account_date (account_number, transaction_date)
+)
+PARTITION BY RANGE (UNIX_TIMESTAMP(transaction_date)) (
+    PARTITION p2026_01 VALUES LESS THAN (UNIX_TIMESTAMP('2026-02-01 00:00:00')),
+    PARTITION p2026_02 VALUES LESS THAN (UNIX_TIMESTAMP('2026-03-01 00:00:00')),
+    PARTITION p2026_03 VALUES LESS THAN (UNIX_TIMESTAMP('2026-04-01 00:00:00')),
+    PARTITION p2026_04 VALUES LESS THAN (UNIX_TIMESTAMP('2026-05-01 00:00:00')),
+    PARTITION p2026_05 VALUES LESS THAN (UNIX_TIMESTAMP('2026-06-01 00:00:00')),
+    PARTITION p2026_06 VALUES LESS THAN (UNIX_TIMESTAMP('2026-07-01 00:00:00')),
+    PARTITION p2026_07 VALUES LESS THAN (UNIX_TIMESTAMP('2026-08-01 00:00:00')),
+    PARTITION p2026_08 VALUES LESS THAN (UNIX_TIMESTAMP('2026-09-01 00:00:00')),
+    PARTITION p2026_09 VALUES LESS THAN (UNIX_TIMESTAMP('2026-10-01 00:00:00')),
+    PARTITION p2026_10 VALUES LESS THAN (UNIX_TIMESTAMP('2026-11-01 00:00:00')),
+    PARTITION p2026_11 VALUES LESS THAN (UNIX_TIMESTAMP('2026-12-01 00:00:00')),
+    PARTITION p2026_12 VALUES LESS THAN (UNIX_TIMESTAMP('2027-01-01 00:00:00')),
+    PARTITION pmax VALUES LESS THAN MAXVALUE
+);
+
+-- Per-account overrides of the default withdrawal/transfer limits
+-- (NULL = account type default, 0 = unlimited)
+CREATE TABLE account_limits (
+    account_number INT PRIMARY KEY,
+    hourly_withdrawal_limit DECIMAL(15,2),
+    daily_withdrawal_limit DECIMAL(15,2),
+    hourly_transfer_limit DECIMAL(15,2),
+    daily_transfer_limit DECIMAL(15,2),
     FOREIGN KEY (account_number) REFERENCES accounts(account_number)
 );